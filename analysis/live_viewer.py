@@ -0,0 +1,181 @@
+import numpy as np
+import cv2
+import mmap
+import os
+import struct
+import time
+
+# -------------------- Global Configuration --------------------
+# Attaches to the shared-memory ring buffer written by the C++ simulator when
+# 'livePublish' is enabled in config.h, and renders it while the run is going.
+# The layout below must match cpp_simulator/live_publisher.h.
+
+SHM_DIR = '/dev/shm'
+SHM_PREFIX = 'pepcitrus_live_'
+
+LIVE_MAGIC = 0x50455043
+LIVE_VERSION = 1
+HEADER_FORMAT = '<IIiiIIQQIi16s'    # live_header (64 bytes)
+SLOT_FORMAT = '<Qqddd'              # live_series_row / live_frame_header (40 bytes)
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+SLOT_SIZE = struct.calcsize(SLOT_FORMAT)
+
+GLOBAL_UPSCALE_FACTOR = 12
+GLOBAL_POLL_SECONDS = 0.02
+GLOBAL_READ_RETRIES = 8
+
+# -------------------- Shared Memory Reader --------------------
+
+
+class live_reader:
+    """
+    Read-only view of a live simulation segment. Every read follows the
+    sequence-lock protocol: the slot is copied, and the copy is discarded if
+    the writer touched the slot in the meantime. The simulator never waits
+    for this reader.
+    """
+
+    def __init__(self, scenario):
+        path = os.path.join(SHM_DIR, SHM_PREFIX + scenario.lower())
+        with open(path, 'rb') as f:
+            self.buffer = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+
+        (magic, version, self.L, self.decimation, self.series_slots, self.frame_slots,
+         _, _, _, _, treatment) = struct.unpack_from(HEADER_FORMAT, self.buffer, 0)
+        if magic != LIVE_MAGIC or version != LIVE_VERSION:
+            raise RuntimeError(f"Segment '{path}' is not a live simulation buffer (version {LIVE_VERSION}).")
+        self.treatment = treatment.split(b'\0')[0].decode()
+
+        cells = self.L * self.L
+        self.frame_slot_size = (SLOT_SIZE + 2 * 4 * cells + 7) & ~7
+        self.series_offset = HEADER_SIZE
+        self.frame_offset = HEADER_SIZE + SLOT_SIZE * self.series_slots
+
+    def close(self):
+        self.buffer.close()
+
+    def counts(self):
+        """Returns (rows published, frames published, finished flag)."""
+        series_count, frame_count, finished = struct.unpack_from('<QQI', self.buffer, 24)
+        return series_count, frame_count, bool(finished)
+
+    def _read_slot(self, offset, n, payload_size):
+        expected = 2 * n + 2
+        for _ in range(GLOBAL_READ_RETRIES):
+            seq_before = struct.unpack_from('<Q', self.buffer, offset)[0]
+            if seq_before != expected:
+                # either still being written, or already overwritten by a newer lap
+                if seq_before > expected:
+                    return None
+                continue
+            data = self.buffer[offset:offset + SLOT_SIZE + payload_size]
+            seq_after = struct.unpack_from('<Q', self.buffer, offset)[0]
+            if seq_after == seq_before:
+                return data
+        return None
+
+    def read_row(self, n):
+        """Returns (time, mean_infection, mean_callose, drug_concentration) or None if lost."""
+        offset = self.series_offset + SLOT_SIZE * (n % self.series_slots)
+        data = self._read_slot(offset, n, 0)
+        if data is None:
+            return None
+        return struct.unpack_from(SLOT_FORMAT, data, 0)[1:]
+
+    def read_frame(self, n):
+        """Returns (time, drug_concentration, infection_grid, callose_grid) or None if lost."""
+        cells = self.L * self.L
+        offset = self.frame_offset + self.frame_slot_size * (n % self.frame_slots)
+        data = self._read_slot(offset, n, 2 * 4 * cells)
+        if data is None:
+            return None
+        _, t, _, _, drug = struct.unpack_from(SLOT_FORMAT, data, 0)
+        grids = np.frombuffer(data, dtype='<f4', count=2 * cells, offset=SLOT_SIZE)
+        return t, drug, grids[:cells].reshape(self.L, self.L), grids[cells:].reshape(self.L, self.L)
+
+
+# -------------------- Rendering --------------------
+
+def render_frame(L, t, drug, infection_grid, callose_grid):
+    """
+    Same color mapping as create_video_frame_continuous in analyze.py.
+    The drug is spatially uniform, so it is broadcast from the scalar.
+    """
+    canvas_bgr = np.zeros((L, L, 3), dtype=np.uint8)
+    drug_max_val = 50.0
+
+    green_channel_values = np.clip(drug / drug_max_val, 0, 1) + callose_grid
+    canvas_bgr[..., 1] = (np.clip(green_channel_values, 0, 1) * 255).astype(np.uint8)
+    red_channel_values = infection_grid + callose_grid
+    canvas_bgr[..., 2] = (np.clip(red_channel_values, 0, 1) * 255).astype(np.uint8)
+
+    size = L * GLOBAL_UPSCALE_FACTOR
+    large_frame = cv2.resize(canvas_bgr, (size, size), interpolation=cv2.INTER_NEAREST)
+    cv2.rectangle(large_frame, (0, 0), (size, 50), (0, 0, 0), -1)
+    cv2.putText(large_frame, f'Time: {t} days', (10, 35), cv2.FONT_HERSHEY_SIMPLEX, 1, (255, 255, 255), 2)
+    return large_frame
+
+
+def wait_for_segment(scenario):
+    print(f"Waiting for live simulation '{scenario}' (start the simulator with livePublish = true)...")
+    while True:
+        try:
+            return live_reader(scenario)
+        except (FileNotFoundError, ValueError, RuntimeError):
+            time.sleep(0.5)
+
+
+def watch(scenario):
+    """
+    Shows the newest available frame and prints the newest time-series row.
+    Frames that were overwritten before they could be read are simply skipped.
+    """
+    reader = wait_for_segment(scenario)
+    print(f"Attached to '{reader.treatment}' (L={reader.L}, one frame every {reader.decimation} steps).")
+
+    shown_frames = 0
+    try:
+        while True:
+            series_count, frame_count, finished = reader.counts()
+
+            if frame_count > shown_frames:
+                frame = reader.read_frame(frame_count - 1)
+                if frame is not None:
+                    cv2.imshow(f'Live simulation: {reader.treatment}', render_frame(reader.L, *frame))
+                shown_frames = frame_count
+
+            if series_count > 0:
+                row = reader.read_row(series_count - 1)
+                if row is not None:
+                    t, mean_i, mean_c, drug = row
+                    print(f"\rStep {t} | Mean Infection: {mean_i:.4f} | Mean Callose: {mean_c:.4f} | Drug: {drug:.4f}", end='')
+
+            if finished and shown_frames == frame_count:
+                print("\nSimulation finished.")
+                cv2.waitKey(0)
+                break
+
+            if cv2.waitKey(1) & 0xFF == ord('q'):
+                break
+            time.sleep(GLOBAL_POLL_SECONDS)
+    finally:
+        reader.close()
+        cv2.destroyAllWindows()
+
+
+# -------------------- Main --------------------
+def main():
+    print("="*55)
+    print(" Pepcitrus Unicamp - iGEM Project Live Simulation Viewer")
+    print("-"*55)
+    print(" Press 'q' in the video window to stop watching.")
+    print("="*55 + "\n")
+
+    scenario = input("Scenario to watch ('control', 'ctx' or 'tetra'): ").strip().lower()
+    if scenario not in ['control', 'ctx', 'tetra']:
+        print("\n--- Invalid choice. Please select 'control', 'ctx' or 'tetra'. ---")
+        return
+    watch(scenario)
+
+if __name__ == "__main__":
+    main()
@@ -12,11 +12,13 @@
  * -ENVIRONMENT AND DURATION: Grid size and simulation time steps;
  * -INFECTION DYNAMICS: Growth and spread rates of the bacteria;
  * -HOST RESPONSE: Parameters for callose production, degradation, and signaling radius;
- * -DRUG PROPERTIES: Doses, potencies and half-lives of the treatments.
+ * -DRUG PROPERTIES: Doses, potencies and half-lives of the treatments;
+ * -LIVE VISUALISATION: Shared-memory publishing of the running simulation;
+ * -OPTIMIZER: Search space and budget of the treatment-schedule optimizer.
  * 
  * Created by: Pepcitrus Unicamp - iGEM project
  * Created on: June 11, 2025
- * Last Modified: September 21,2025.
+ * Last Modified: October 18, 2026.
  *                  
  *         Have fun! :)
  * =====================================================================================
@@ -56,7 +58,24 @@ struct config {
     drug_params CTXparams = {15.0 / 80.0, 0.40, 2.0, 3.0, 14.0, 100.0};
     drug_params TETRACYCLINEparams = {150.0 / 80.0, 1.0, 2.0, 3.0, 14.0, 200.0};
 
-   
+    // --- Live Visualisation (POSIX shared memory) ---
+    bool livePublish = false;    // publish the running simulation to shared memory for a live viewer
+    int liveDecimation = 10;     // publish one grid frame every N time steps
+    int liveSeriesSlots = 4096;  // capacity of the time-series ring (rows)
+    int liveFrameSlots = 64;     // capacity of the frame ring (grids)
+
+    // --- Treatment-Schedule Optimizer ---
+    int optCandidates = 1024;        // schedules sampled for the first rung
+    int optRungs = 4;                // successive-halving rounds (the last one runs the full 'extraSteps')
+    int optEta = 3;                  // only the best 1/optEta schedules advance to the next rung
+    int optMaxDoses = 4;             // max applications per schedule
+    int optMinInterval = 30;         // min days between applications
+    int optMaxInterval = 365;        // max days between applications
+    int optMaxDelay = 180;           // latest first application (days after treatment start)
+    double optMinDoseScale = 0.25;   // min amount per application (multiple of the drug's 'dose')
+    double optMaxDoseScale = 2.0;    // max amount per application (multiple of the drug's 'dose')
+    double optDrugPenalty = 0.02;    // score cost per default dose applied
+    int optThreads = 0;              // worker threads (0 = all hardware threads)
 };
 
 
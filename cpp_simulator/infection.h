@@ -19,7 +19,7 @@
  * to treatments and host defense.
  * Created by: Pepcitrus Unicamp - iGEM project
  * Created on: June 14, 2025
- * Last Modified: September 21, 2025.
+ * Last Modified: October 18, 2026 (CTX and tetracycline can act in the same step).
  * =====================================================================================
  */
 
@@ -36,7 +36,7 @@ public:
     infection(const config& cfg); //constructor that initializes the model with simulation parameters
     void initialize(); //resets the grid and starts the infection at a single random point
     void spread(const std::vector<std::vector<double>>& C, double beta, double inhibitionFactor, const network& net); //models the spatial spread of the infection to neighboring cells
-    void update(const std::vector<std::vector<double>>& C, double drugConc, bool isBactericidal, const drug_params& drugParams);  //updates the infection load in each cell according to local dynamics.
+    void update(const std::vector<std::vector<double>>& C, double ctxConc, double tetraConc, const drug_params& ctxParams, const drug_params& tetraParams);  //updates the infection load in each cell according to local dynamics, under bactericidal (CTX) and bacteriostatic (tetracycline) drug concentrations.
     double get_mean() const;  //calculates the average infection load across the entire grid
     std::vector<std::vector<double>>& get_matrix(); //returns a reference to the infection matrix for other classes to read
 };
@@ -75,7 +75,21 @@ inline void infection::spread(const std::vector<std::vector<double>>& C, double
     I = newI;
 }
 
-inline void infection::update(const std::vector<std::vector<double>>& C, double drugConc, bool isBactericidal, const drug_params& drugParams) {
+inline void infection::update(const std::vector<std::vector<double>>& C, double ctxConc, double tetraConc, const drug_params& ctxParams, const drug_params& tetraParams) {
+    // the drug effects do not depend on the cell, so they are computed once per step
+    double killFraction = 0.0;
+    if (ctxConc >= 1e-9) {
+        killFraction = pow(ctxConc / ctxParams.EC50, ctxParams.hillN) /
+                       (pow(ctxConc / ctxParams.EC50, ctxParams.hillN) + 1.0);
+        killFraction = std::min(1.0, killFraction * ctxParams.killScale);
+    }
+    double inhibition = 0.0;
+    if (tetraConc >= 1e-9) {
+        inhibition = pow(tetraConc / tetraParams.EC50, tetraParams.hillN) /
+                     (pow(tetraConc / tetraParams.EC50, tetraParams.hillN) + 1.0);
+        inhibition = std::min(1.0, inhibition * tetraParams.killScale);
+    }
+
     for (int i = 0; i < L; ++i) {
         for (int j = 0; j < L; ++j) {
             if (I[i][j] <= 0) continue;
@@ -83,31 +97,12 @@ inline void infection::update(const std::vector<std::vector<double>>& C, double
             double growth = r * I[i][j] * (1.0 - I[i][j] / Imax);
             double naturalDeath = deltaI * I[i][j];
             double baseCalloseEffect = d * C[i][j] * I[i][j];
-            
-            double dI = 0.0;
-
-            if (drugConc < 1e-9) {
-                dI = growth - naturalDeath - baseCalloseEffect;
-
-            } else {
-                if (isBactericidal) {
-                    double killFraction = pow(drugConc / drugParams.EC50, drugParams.hillN) /
-                                          (pow(drugConc / drugParams.EC50, drugParams.hillN) + 1.0);
-                    killFraction *= drugParams.killScale;
-                    dI = growth - naturalDeath - baseCalloseEffect - (std::min(1.0, killFraction) * I[i][j]);
-
-                } else {
-                    double inhibition = pow(drugConc / drugParams.EC50, drugParams.hillN) /
-                                        (pow(drugConc / drugParams.EC50, drugParams.hillN) + 1.0);
-                    inhibition *= drugParams.killScale;
-                    inhibition = std::min(1.0, inhibition);
-
-                    double effectiveGrowth = growth * (1.0 - inhibition);
-                    double activeClearingEffect = (model_constants::TETRACYCLINE_ACTIVE_CLEARING * inhibition) * I[i][j];
-                    
-                    dI = effectiveGrowth - naturalDeath - baseCalloseEffect - activeClearingEffect;
-                }
-            }
+
+            double effectiveGrowth = growth * (1.0 - inhibition); // bacteriostatic: slows growth
+            double bactericidalEffect = killFraction * I[i][j]; // bactericidal: kills a fraction of the load
+            double activeClearingEffect = (model_constants::TETRACYCLINE_ACTIVE_CLEARING * inhibition) * I[i][j];
+
+            double dI = effectiveGrowth - naturalDeath - baseCalloseEffect - bactericidalEffect - activeClearingEffect;
 
             I[i][j] += dI;
             if (I[i][j] < model_constants::NUMERICAL_EXTINCTION_THRESHOLD) I[i][j] = 0.0;
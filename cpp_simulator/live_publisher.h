@@ -0,0 +1,283 @@
+#ifndef LIVE_PUBLISHER_H
+#define LIVE_PUBLISHER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <cerrno>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * =====================================================================================
+ *                              CLASS LIVE_PUBLISHER
+ * =====================================================================================
+ * Publishes the running simulation into a POSIX shared-memory segment so that a
+ * local viewer (e.g. analysis/live_viewer.py) can attach and render in real time.
+ *
+ * The segment holds two ring buffers: one with a time-series row for every step and
+ * one with decimated grid frames. Each slot carries its own sequence lock: the
+ * writer makes it odd before copying and even afterwards, so a reader copies the
+ * slot and retries if the sequence changed. The writer never waits for readers,
+ * so a slow viewer only loses old slots and never stalls the simulation.
+ *
+ * Segment layout (all little-endian, 8-byte aligned):
+ *   live_header
+ *   live_series_row[seriesSlots]
+ *   frame slot[frameSlots] = live_frame_header + float infection[L*L] + float callose[L*L]
+ *
+ * Created by: Pepcitrus Unicamp - iGEM project
+ * Created on: October 18, 2026
+ * Last Modified: October 18, 2026 (never removes another simulator's segment).
+ * =====================================================================================
+ */
+
+namespace live_layout {
+
+    constexpr uint32_t MAGIC = 0x50455043;  // "PEPC"
+    constexpr uint32_t VERSION = 1;
+
+    struct live_header {
+        uint32_t magic;
+        uint32_t version;
+        int32_t L;                          // grid dimension of every frame
+        int32_t decimation;                 // a frame is published every 'decimation' steps
+        uint32_t seriesSlots;               // capacity of the time-series ring
+        uint32_t frameSlots;                // capacity of the frame ring
+        std::atomic<uint64_t> seriesCount;  // total rows published so far
+        std::atomic<uint64_t> frameCount;   // total frames published so far
+        std::atomic<uint32_t> finished;     // set to 1 once the run is over
+        int32_t ownerPid;                   // process that created the segment
+        char treatment[16];                 // scenario name, null terminated
+    };
+
+    struct live_series_row {
+        std::atomic<uint64_t> seq;          // 2*n+1 while row n is written, 2*n+2 when complete
+        int64_t time;
+        double meanInfection;
+        double meanCallose;
+        double drugConcentration;
+    };
+
+    struct live_frame_header {
+        std::atomic<uint64_t> seq;          // same convention as live_series_row::seq
+        int64_t time;
+        double meanInfection;
+        double meanCallose;
+        double drugConcentration;
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared-memory seqlock needs lock-free 64-bit atomics");
+    static_assert(sizeof(live_header) == 64, "unexpected live_header layout");
+    static_assert(sizeof(live_series_row) == 40, "unexpected live_series_row layout");
+    static_assert(sizeof(live_frame_header) == 40, "unexpected live_frame_header layout");
+}
+
+class live_publisher {
+private:
+    std::string shmName;  // name passed to shm_open (starts with '/')
+    void* base = nullptr; // start of the mapped segment
+    size_t mappedSize = 0;
+    int L = 0;
+    int decimation = 1;
+    size_t frameSlotSize = 0;
+    dev_t shmDevice = 0;  // identity of the segment this process created, so the
+    ino_t shmInode = 0;   // destructor never unlinks a newer segment with the same name
+    std::vector<float> scratch; // grid converted to float before the copy into shared memory
+
+    bool unlink_if_stale() const; //removes an existing segment only if the process that created it is gone
+    bool owns_segment() const; //true if 'shmName' still refers to the segment this process created
+
+    live_layout::live_header* header() const;
+    live_layout::live_series_row* series_slot(uint64_t n) const;
+    live_layout::live_frame_header* frame_slot(uint64_t n) const;
+
+public:
+    live_publisher(const std::string& name, const std::string& treatment, int L, int decimation, int seriesSlots, int frameSlots); //creates and maps the segment; is_open() is false on failure
+    ~live_publisher(); //marks the run as finished and unmaps/unlinks the segment
+    live_publisher(const live_publisher&) = delete;
+    live_publisher& operator=(const live_publisher&) = delete;
+
+    bool is_open() const; //true if the segment was created successfully
+    void publish_step(int t, double meanI, double meanC, double drugConc); //appends a row to the time-series ring
+    void publish_frame(int t, double meanI, double meanC, double drugConc,
+                       const std::vector<std::vector<double>>& infection,
+                       const std::vector<std::vector<double>>& callose); //appends a frame if 't' is on the decimation grid
+};
+
+
+// --- Functions Bodies ---
+
+inline live_publisher::live_publisher(const std::string& name, const std::string& treatment, int L, int decimation, int seriesSlots, int frameSlots)
+    : shmName(name), L(L), decimation(std::max(decimation, 1)) {
+    using namespace live_layout;
+
+    seriesSlots = std::max(seriesSlots, 1);
+    frameSlots = std::max(frameSlots, 1);
+    frameSlotSize = sizeof(live_frame_header) + 2 * sizeof(float) * L * L;
+    frameSlotSize = (frameSlotSize + 7) & ~size_t(7);
+    mappedSize = sizeof(live_header) + sizeof(live_series_row) * seriesSlots + frameSlotSize * frameSlots;
+    scratch.resize(static_cast<size_t>(L) * L);
+
+    int fd = shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0 && errno == EEXIST && unlink_if_stale()) {
+        // the segment was left behind by a crashed run
+        fd = shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    }
+    if (fd < 0) {
+        if (errno == EEXIST) {
+            std::cerr << "Live publish disabled: shared memory '" << shmName << "' is in use by another simulator.\n";
+        } else {
+            std::cerr << "Live publish disabled: could not create shared memory '" << shmName << "'.\n";
+        }
+        return;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || ftruncate(fd, static_cast<off_t>(mappedSize)) != 0) {
+        std::cerr << "Live publish disabled: could not size shared memory '" << shmName << "'.\n";
+        close(fd);
+        shm_unlink(shmName.c_str());
+        return;
+    }
+    void* mem = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) {
+        std::cerr << "Live publish disabled: could not map shared memory '" << shmName << "'.\n";
+        shm_unlink(shmName.c_str());
+        return;
+    }
+    base = mem;
+    shmDevice = st.st_dev;
+    shmInode = st.st_ino;
+
+    // ftruncate zero-fills, so every slot sequence starts at 0 ("never written")
+    live_header* h = header();
+    h->L = L;
+    h->decimation = this->decimation;
+    h->seriesSlots = static_cast<uint32_t>(seriesSlots);
+    h->frameSlots = static_cast<uint32_t>(frameSlots);
+    std::strncpy(h->treatment, treatment.c_str(), sizeof(h->treatment) - 1);
+    h->ownerPid = static_cast<int32_t>(getpid());
+    h->version = VERSION;
+    // magic goes last so a reader never sees a half-initialised header
+    std::atomic_thread_fence(std::memory_order_release);
+    h->magic = MAGIC;
+
+    std::cout << "Live publishing to shared memory: " << shmName << std::endl;
+}
+
+inline live_publisher::~live_publisher() {
+    if (!base) return;
+    header()->finished.store(1, std::memory_order_release);
+    munmap(base, mappedSize);
+    // readers that are already attached keep their mapping until they close it
+    if (owns_segment()) {
+        shm_unlink(shmName.c_str());
+    }
+}
+
+inline bool live_publisher::unlink_if_stale() const {
+    int fd = shm_open(shmName.c_str(), O_RDONLY, 0);
+    if (fd < 0) return errno == ENOENT; // removed in the meantime, so the name is free again
+
+    struct stat st;
+    bool stale = false;
+    if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(live_layout::live_header)) {
+        void* mem = mmap(nullptr, sizeof(live_layout::live_header), PROT_READ, MAP_SHARED, fd, 0);
+        if (mem != MAP_FAILED) {
+            const auto* h = static_cast<const live_layout::live_header*>(mem);
+            // a segment still being initialised has no magic yet and is treated as in use
+            stale = h->magic == live_layout::MAGIC && h->ownerPid > 0
+                    && kill(static_cast<pid_t>(h->ownerPid), 0) != 0 && errno == ESRCH;
+            munmap(mem, sizeof(live_layout::live_header));
+        }
+    }
+    close(fd);
+
+    if (!stale) return false;
+    shm_unlink(shmName.c_str());
+    return true;
+}
+
+inline bool live_publisher::owns_segment() const {
+    int fd = shm_open(shmName.c_str(), O_RDONLY, 0);
+    if (fd < 0) return false;
+    struct stat st;
+    bool same = fstat(fd, &st) == 0 && st.st_dev == shmDevice && st.st_ino == shmInode;
+    close(fd);
+    return same;
+}
+
+inline bool live_publisher::is_open() const { return base != nullptr; }
+
+inline live_layout::live_header* live_publisher::header() const {
+    return static_cast<live_layout::live_header*>(base);
+}
+
+inline live_layout::live_series_row* live_publisher::series_slot(uint64_t n) const {
+    auto* rows = reinterpret_cast<live_layout::live_series_row*>(static_cast<char*>(base) + sizeof(live_layout::live_header));
+    return &rows[n % header()->seriesSlots];
+}
+
+inline live_layout::live_frame_header* live_publisher::frame_slot(uint64_t n) const {
+    char* frames = static_cast<char*>(base) + sizeof(live_layout::live_header)
+                   + sizeof(live_layout::live_series_row) * header()->seriesSlots;
+    return reinterpret_cast<live_layout::live_frame_header*>(frames + frameSlotSize * (n % header()->frameSlots));
+}
+
+inline void live_publisher::publish_step(int t, double meanI, double meanC, double drugConc) {
+    if (!base) return;
+    live_layout::live_header* h = header();
+    uint64_t n = h->seriesCount.load(std::memory_order_relaxed);
+    live_layout::live_series_row* row = series_slot(n);
+
+    row->seq.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    row->time = t;
+    row->meanInfection = meanI;
+    row->meanCallose = meanC;
+    row->drugConcentration = drugConc;
+    row->seq.store(2 * n + 2, std::memory_order_release);
+
+    h->seriesCount.store(n + 1, std::memory_order_release);
+}
+
+inline void live_publisher::publish_frame(int t, double meanI, double meanC, double drugConc,
+                                          const std::vector<std::vector<double>>& infection,
+                                          const std::vector<std::vector<double>>& callose) {
+    if (!base || t % decimation != 0) return;
+    live_layout::live_header* h = header();
+    uint64_t n = h->frameCount.load(std::memory_order_relaxed);
+    live_layout::live_frame_header* slot = frame_slot(n);
+    float* grids = reinterpret_cast<float*>(reinterpret_cast<char*>(slot) + sizeof(live_layout::live_frame_header));
+    const size_t cells = static_cast<size_t>(L) * L;
+
+    slot->seq.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot->time = t;
+    slot->meanInfection = meanI;
+    slot->meanCallose = meanC;
+    slot->drugConcentration = drugConc;
+
+    const std::vector<std::vector<double>>* sources[2] = {&infection, &callose};
+    for (int k = 0; k < 2; ++k) {
+        for (int i = 0; i < L; ++i) {
+            for (int j = 0; j < L; ++j) {
+                scratch[i * L + j] = static_cast<float>((*sources[k])[i][j]);
+            }
+        }
+        std::memcpy(grids + k * cells, scratch.data(), cells * sizeof(float));
+    }
+    slot->seq.store(2 * n + 2, std::memory_order_release);
+
+    h->frameCount.store(n + 1, std::memory_order_release);
+}
+
+#endif
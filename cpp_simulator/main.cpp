@@ -1,4 +1,5 @@
 #include "simulation.h"
+#include "optimizer.h"
 #include <iostream>
 #include <string>
 #include <limits> 
@@ -15,7 +16,7 @@
  * creates the main simulation object, and calls the 'run()' method.
  * * Created by: Pepcitrus Unicamp - iGEM project
  * Created on: June 11, 2025
- * Last Modified: October 6, 2025 (Refactored for Interactive Loop and 'all' option).
+ * Last Modified: October 18, 2026 (Added 'optimize' option).
  * =====================================================================================
  */
 
@@ -50,6 +51,7 @@ int main() {
         std::cout << "  'ctx'     -> CTX (bactericidal) treatment\n";
         std::cout << "  'tetra'   -> Oxytetracycline (bacteriostatic) treatment\n";
         std::cout << "  'all'     -> Run all scenarios (control, ctx, tetra)\n";
+        std::cout << "  'optimize'-> Search for the best treatment schedule\n";
         std::cout << "  'exit'    -> Quit the program\n";
         std::cout << "Enter your choice: " << std::flush;
 
@@ -60,6 +62,12 @@ int main() {
             scenariosToRun.push_back(userInput);
         } else if (userInput == "all") {
             scenariosToRun = {"control", "ctx", "tetra"};
+        } else if (userInput == "optimize") {
+            std::cout << "\nStarting treatment-schedule optimization. This may take a while..." << std::endl << std::endl;
+            optimizer opt;
+            opt.run();
+            std::cout << "\nOptimization completed. Returning to menu.\n" << std::endl;
+            continue;
         } else if (userInput == "exit") {
             keepRunning = false;
         } else {
@@ -0,0 +1,298 @@
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include "config.h"
+#include "network.h"
+#include "infection.h"
+#include "callose.h"
+#include "simulation.h"
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+/*
+ * =====================================================================================
+ *                                  CLASS OPTIMIZER
+ * =====================================================================================
+ * Searches for treatment schedules (dose timing, amount and CTX/tetracycline
+ * combination) that minimise post-treatment infection at the lowest total drug use.
+ *
+ * The pre-treatment period is simulated only once; every candidate schedule starts
+ * from a copy of that shared state (including the random generator, so candidates
+ * are compared under the same random events). Candidates are ranked with successive
+ * halving: all of them run the same number of days after their own first dose, only
+ * the best 1/optEta continue, and so on until the survivors have run the full period.
+ * Clearly losing schedules are therefore pruned on their partial trajectories, but
+ * never before their treatment has started.
+ *
+ * Score (lower is better) = mean infection over the post-treatment steps run so far
+ *                           + optDrugPenalty * total drug (in default-dose units).
+ * While pruning, only the doses already given count towards the drug term.
+ *
+ * Created by: Pepcitrus Unicamp - iGEM project
+ * Created on: October 18, 2026
+ * Last Modified: October 18, 2026.
+ * =====================================================================================
+ */
+
+// A candidate treatment schedule and the state of its evaluation
+struct schedule_candidate {
+    // --- Schedule ---
+    int firstDose;              // first application (days after treatment start)
+    int numDoses;               // number of applications
+    int interval;               // days between applications
+    double ctxScale;            // CTX per application, as a multiple of CTXparams.dose (0 = not used)
+    double tetraScale;          // tetracycline per application, as a multiple of TETRACYCLINEparams.dose (0 = not used)
+    std::vector<int> doseTimes; // application times derived from the fields above
+
+    // --- Evaluation State ---
+    infection infection_obj;
+    callose callose_obj;
+    int stepsDone = 0;          // post-treatment steps simulated so far
+    int rung = 0;               // last successive-halving rung the candidate took part in
+    double infectionSum = 0.0;  // sum of the mean infection over those steps
+    double finalInfection = 0.0;
+    bool extinct = false;       // infection cleared; it can never come back, so the rest of the run is skipped
+
+    schedule_candidate(int firstDose, int numDoses, int interval, double ctxScale, double tetraScale,
+                       const infection& infection_state, const callose& callose_state);
+    double drug_use() const; //total drug of the whole schedule, in default-dose units
+    double drug_given() const; //drug of the doses given within the steps run so far, in default-dose units
+    double mean_infection() const; //mean infection over the post-treatment steps run so far
+    double score(double drugPenalty) const; //final score, charging the whole schedule
+    double pruning_score(double drugPenalty) const; //partial score, charging only the doses already given
+    std::string drug_name() const;
+};
+
+class optimizer {
+private:
+    config cfg;
+    network net;
+    std::mt19937 gen; // samples the candidate schedules
+
+    // samples a random schedule within the limits set in config.h
+    schedule_candidate sample_candidate(const infection& infection_state, const callose& callose_state);
+    // simulates a candidate's post-treatment period up to 'daysAfterFirstDose' days after its first dose
+    void evaluate(schedule_candidate& candidate, int daysAfterFirstDose) const;
+    // evaluates all candidates in parallel up to 'daysAfterFirstDose' days after their first dose
+    void evaluate_all(std::vector<schedule_candidate>& candidates, int daysAfterFirstDose) const;
+    // writes every candidate (pruned ones included) ranked by progress and score
+    void save_results(std::vector<schedule_candidate>& candidates, const std::string& filename) const;
+
+public:
+    optimizer(); //constructor that initializes the optimizer with the settings in config.h
+    void run(); //runs the full schedule search and saves the ranking to optimizer_results.csv
+};
+
+
+// --- Functions Bodies ---
+
+inline schedule_candidate::schedule_candidate(int firstDose, int numDoses, int interval, double ctxScale, double tetraScale,
+                                              const infection& infection_state, const callose& callose_state)
+    : firstDose(firstDose), numDoses(numDoses), interval(interval), ctxScale(ctxScale), tetraScale(tetraScale),
+      infection_obj(infection_state), callose_obj(callose_state) {
+    for (int k = 0; k < numDoses; ++k) {
+        doseTimes.push_back(firstDose + k * interval);
+    }
+}
+
+inline double schedule_candidate::drug_use() const { return numDoses * (ctxScale + tetraScale); }
+
+inline double schedule_candidate::drug_given() const {
+    int given = 0;
+    for (int doseTime : doseTimes) {
+        if (doseTime < stepsDone) ++given;
+    }
+    return given * (ctxScale + tetraScale);
+}
+
+inline double schedule_candidate::mean_infection() const { return infectionSum / std::max(stepsDone, 1); }
+
+inline double schedule_candidate::score(double drugPenalty) const { return mean_infection() + drugPenalty * drug_use(); }
+
+inline double schedule_candidate::pruning_score(double drugPenalty) const { return mean_infection() + drugPenalty * drug_given(); }
+
+inline std::string schedule_candidate::drug_name() const {
+    if (ctxScale > 0 && tetraScale > 0) return "ctx+tetra";
+    return ctxScale > 0 ? "ctx" : "tetra";
+}
+
+inline optimizer::optimizer() : cfg(), net(cfg.L, cfg.signalR) {
+    gen.seed(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+}
+
+inline schedule_candidate optimizer::sample_candidate(const infection& infection_state, const callose& callose_state) {
+    std::uniform_int_distribution<int> drugChoice(0, 2);
+    std::uniform_int_distribution<int> dosesDist(1, std::max(cfg.optMaxDoses, 1));
+    std::uniform_int_distribution<int> intervalDist(cfg.optMinInterval, std::max(cfg.optMaxInterval, cfg.optMinInterval));
+    std::uniform_int_distribution<int> delayDist(0, std::max(std::min(cfg.optMaxDelay, cfg.extraSteps - 1), 0));
+    std::uniform_real_distribution<double> scaleDist(std::min(cfg.optMinDoseScale, cfg.optMaxDoseScale),
+                                                     std::max(cfg.optMinDoseScale, cfg.optMaxDoseScale));
+
+    int drug = drugChoice(gen); // 0 = CTX, 1 = tetracycline, 2 = both
+    int firstDose = delayDist(gen);
+    int numDoses = dosesDist(gen);
+    int interval = intervalDist(gen);
+    double ctxScale = (drug != 1) ? scaleDist(gen) : 0.0;
+    double tetraScale = (drug != 0) ? scaleDist(gen) : 0.0;
+
+    // applications after the end of the run would cost drug without any effect
+    while (numDoses > 1 && firstDose + (numDoses - 1) * interval >= cfg.extraSteps) {
+        --numDoses;
+    }
+    return schedule_candidate(firstDose, numDoses, interval, ctxScale, tetraScale, infection_state, callose_state);
+}
+
+inline void optimizer::evaluate(schedule_candidate& candidate, int daysAfterFirstDose) const {
+    int targetSteps = std::min(candidate.firstDose + daysAfterFirstDose, cfg.extraSteps);
+    if (candidate.extinct) {
+        candidate.stepsDone = std::max(candidate.stepsDone, targetSteps);
+        return;
+    }
+
+    drug_params ctxParams = cfg.CTXparams;
+    drug_params tetraParams = cfg.TETRACYCLINEparams;
+    ctxParams.dose *= candidate.ctxScale;
+    tetraParams.dose *= candidate.tetraScale;
+    int treatmentStart = cfg.steps;
+
+    for (int s = candidate.stepsDone; s < targetSteps; ++s) {
+        int t = treatmentStart + s;
+        double ctxConc = candidate.ctxScale > 0 ? simulation::calculate_total_concentration(ctxParams, candidate.doseTimes, t, treatmentStart) : 0.0;
+        double tetraConc = candidate.tetraScale > 0 ? simulation::calculate_total_concentration(tetraParams, candidate.doseTimes, t, treatmentStart) : 0.0;
+
+        simulation::advance(cfg, net, candidate.infection_obj, candidate.callose_obj, ctxConc, tetraConc);
+
+        double meanI = candidate.infection_obj.get_mean();
+        candidate.infectionSum += meanI;
+        candidate.finalInfection = meanI;
+        candidate.stepsDone = s + 1;
+
+        if (meanI == 0.0) {
+            // spread needs an infected cell, so the remaining steps all contribute zero
+            candidate.extinct = true;
+            candidate.stepsDone = targetSteps;
+            return;
+        }
+    }
+}
+
+inline void optimizer::evaluate_all(std::vector<schedule_candidate>& candidates, int daysAfterFirstDose) const {
+    int numThreads = cfg.optThreads > 0 ? cfg.optThreads : static_cast<int>(std::thread::hardware_concurrency());
+    numThreads = std::max(1, std::min(numThreads, static_cast<int>(candidates.size())));
+
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t k = next++; k < candidates.size(); k = next++) {
+            evaluate(candidates[k], daysAfterFirstDose);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int k = 0; k < numThreads; ++k) {
+        threads.emplace_back(worker);
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+}
+
+inline void optimizer::save_results(std::vector<schedule_candidate>& candidates, const std::string& filename) const {
+    // candidates that went further were judged on more of the trajectory, so they rank first;
+    // within a rung they keep the order in which they were pruned
+    std::sort(candidates.begin(), candidates.end(), [this](const schedule_candidate& a, const schedule_candidate& b) {
+        if (a.rung != b.rung) return a.rung > b.rung;
+        return a.pruning_score(cfg.optDrugPenalty) < b.pruning_score(cfg.optDrugPenalty);
+    });
+
+    std::ofstream outfile(filename);
+    outfile << "rank,drug,num_doses,first_dose,interval,ctx_dose,tetra_dose,total_drug,mean_infection,final_infection,score,steps_evaluated,rung\n";
+    for (size_t k = 0; k < candidates.size(); ++k) {
+        const schedule_candidate& c = candidates[k];
+        outfile << k + 1 << "," << c.drug_name() << "," << c.numDoses << "," << c.firstDose << "," << c.interval << ","
+                << c.ctxScale * cfg.CTXparams.dose << "," << c.tetraScale * cfg.TETRACYCLINEparams.dose << ","
+                << c.drug_use() << "," << c.mean_infection() << "," << c.finalInfection << ","
+                << c.score(cfg.optDrugPenalty) << "," << c.stepsDone << "," << c.rung + 1 << "\n";
+    }
+    outfile.close();
+}
+
+inline void optimizer::run() {
+    // --- Shared pre-treatment state ---
+    infection infection_state(cfg);
+    callose callose_state(cfg);
+    infection_state.initialize();
+    callose_state.initialize();
+    for (int t = 0; t < cfg.steps; ++t) {
+        simulation::advance(cfg, net, infection_state, callose_state, 0.0, 0.0);
+    }
+    std::cout << "Pre-treatment state ready (day " << cfg.steps << ") | Mean Infection: " << infection_state.get_mean()
+              << " | Mean Callose: " << callose_state.get_mean() << "\n";
+
+    // --- Candidates (the current single-dose regimens are kept as references) ---
+    std::vector<schedule_candidate> candidates;
+    candidates.emplace_back(0, 1, 0, 1.0, 0.0, infection_state, callose_state);
+    candidates.emplace_back(0, 1, 0, 0.0, 1.0, infection_state, callose_state);
+    while (static_cast<int>(candidates.size()) < cfg.optCandidates) {
+        candidates.push_back(sample_candidate(infection_state, callose_state));
+    }
+
+    // --- Successive halving ---
+    int rungs = std::max(cfg.optRungs, 1);
+    int eta = std::max(cfg.optEta, 2);
+    std::vector<schedule_candidate> pruned;
+
+    for (int rung = 0; rung < rungs; ++rung) {
+        // the last rung always reaches the end of the run, whatever the first dose
+        int daysAfterFirstDose = static_cast<int>(cfg.extraSteps / std::pow(eta, rungs - 1 - rung));
+        daysAfterFirstDose = std::max(daysAfterFirstDose, 1);
+        if (rung == rungs - 1) daysAfterFirstDose = cfg.extraSteps;
+
+        std::cout << "Rung " << rung + 1 << "/" << rungs << ": evaluating " << candidates.size()
+                  << " schedules up to " << daysAfterFirstDose << " days after their first dose..." << std::endl;
+        for (auto& c : candidates) {
+            c.rung = rung;
+        }
+        evaluate_all(candidates, daysAfterFirstDose);
+
+        // all survivors of the last rung have run the full period, so the final score applies
+        bool finalRung = (rung == rungs - 1);
+        std::sort(candidates.begin(), candidates.end(), [this, finalRung](const schedule_candidate& a, const schedule_candidate& b) {
+            if (finalRung) return a.score(cfg.optDrugPenalty) < b.score(cfg.optDrugPenalty);
+            return a.pruning_score(cfg.optDrugPenalty) < b.pruning_score(cfg.optDrugPenalty);
+        });
+
+        if (rung < rungs - 1) {
+            size_t keep = std::max<size_t>(1, (candidates.size() + eta - 1) / eta);
+            // the pruned candidates keep their partial scores for the results file
+            for (size_t k = keep; k < candidates.size(); ++k) {
+                pruned.push_back(std::move(candidates[k]));
+            }
+            candidates.erase(candidates.begin() + keep, candidates.end());
+        }
+    }
+
+    std::cout << "\nBest schedules (score = mean infection + " << cfg.optDrugPenalty << " x total drug):\n";
+    for (size_t k = 0; k < std::min<size_t>(5, candidates.size()); ++k) {
+        const schedule_candidate& c = candidates[k];
+        std::cout << "  " << k + 1 << ". " << c.drug_name() << " | " << c.numDoses << " dose(s) from day " << c.firstDose
+                  << " every " << c.interval << " days | CTX x" << c.ctxScale << " | Tetra x" << c.tetraScale
+                  << " | Mean Infection: " << c.mean_infection() << " | Final Infection: " << c.finalInfection
+                  << " | Score: " << c.score(cfg.optDrugPenalty) << "\n";
+    }
+
+    for (auto& c : pruned) {
+        candidates.push_back(std::move(c));
+    }
+    save_results(candidates, "optimizer_results.csv");
+    std::cout << "Optimization finished. Results saved to: optimizer_results.csv\n";
+}
+
+#endif
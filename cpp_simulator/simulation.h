@@ -5,6 +5,7 @@
 #include "infection.h"
 #include "callose.h"
 #include "therapeutic.h"
+#include "live_publisher.h"
 #include <string>
 #include <vector>
 #include <iostream>
@@ -13,6 +14,7 @@
 #include <filesystem>
 #include <iomanip>
 #include <sstream>
+#include <memory>
 
 /*
  * ==============================================================================
@@ -20,11 +22,12 @@
  * ===============================================================================
  * The main class that coordinates the entire simulation.
  * It initializes the components, manages the main time loop, applies treatments,
- * and logs the output data.
+ * and logs the output data. When 'cfg.livePublish' is set, every step is also
+ * published to shared memory for live visualisation (see live_publisher.h).
  * 
  * Created by: Pepcitrus Unicamp - iGEM project
  * Created on: August , 2025
- * Last Modified: September 19,2025.
+ * Last Modified: October 18, 2026 (time step factored into 'advance' for the optimizer).
  * ==================================================================================
  */
 
@@ -37,9 +40,6 @@ private:
     callose callose_obj;     
     std::vector<int> doseTimes;  //vector to store the time points of drug administration
     
-    // calculates the total drug concentration at the current time, summing the effects of all previous doses
-    double calculate_total_concentration(const drug_params& params, int globalTime, int treatmentStart) const; 
-    
     // Helper function to save the combined state of all grids to a single file
     void save_combined_data(
         const std::vector<std::vector<double>>& infection,
@@ -51,6 +51,12 @@ private:
 public:
     simulation(); //constructor that initializes the simulation and all its components 
     void run(const std::string& treatment); //executes the full simulation for a specific treatment scenario
+
+    // calculates the total drug concentration at the current time, summing the effects of all doses given so far
+    static double calculate_total_concentration(const drug_params& params, const std::vector<int>& doseTimes, int globalTime, int treatmentStart);
+
+    // advances the coupled infection/callose model by one time step under the given CTX and tetracycline concentrations
+    static void advance(const config& cfg, const network& net, infection& infection_obj, callose& callose_obj, double ctxConc, double tetraConc);
 };
 
 
@@ -58,7 +64,7 @@ public:
 
 inline simulation::simulation() : cfg(), net(cfg.L, cfg.signalR), infection_obj(cfg), callose_obj(cfg) {}
 
-inline double simulation::calculate_total_concentration(const drug_params& params, int globalTime, int treatmentStart) const {
+inline double simulation::calculate_total_concentration(const drug_params& params, const std::vector<int>& doseTimes, int globalTime, int treatmentStart) {
     double totalConcentration = 0.0;
     for (int doseTime : doseTimes) {
         double timeSinceDose = globalTime - (treatmentStart + doseTime);
@@ -67,6 +73,21 @@ inline double simulation::calculate_total_concentration(const drug_params& param
     return totalConcentration;
 }
 
+inline void simulation::advance(const config& cfg, const network& net, infection& infection_obj, callose& callose_obj, double ctxConc, double tetraConc) {
+    // tetracycline is bacteriostatic: besides slowing growth it also inhibits the spread
+    double inhibitionFactor = 0.0;
+    if (tetraConc > 1e-9) {
+        const auto& p = cfg.TETRACYCLINEparams;
+        inhibitionFactor = pow(tetraConc / p.EC50, p.hillN) / (pow(tetraConc / p.EC50, p.hillN) + 1.0);
+        inhibitionFactor = std::min(1.0, inhibitionFactor * p.killScale);
+    }
+    infection_obj.spread(callose_obj.get_matrix(), cfg.beta, inhibitionFactor, net);
+
+    infection_obj.update(callose_obj.get_matrix(), ctxConc, tetraConc, cfg.CTXparams, cfg.TETRACYCLINEparams);
+
+    callose_obj.update(infection_obj.get_matrix(), net);
+}
+
 inline void simulation::save_combined_data(
     const std::vector<std::vector<double>>& infection,
     const std::vector<std::vector<double>>& callose,
@@ -101,44 +122,41 @@ inline void simulation::run(const std::string& treatment) {
     std::ofstream file("results_" + treatment + ".csv");
     file << "time,mean_infection,mean_callose,drug_concentration\n";
 
+    std::unique_ptr<live_publisher> live;
+    if (cfg.livePublish) {
+        live = std::make_unique<live_publisher>("/pepcitrus_live_" + treatment, treatment, cfg.L,
+                                                cfg.liveDecimation, cfg.liveSeriesSlots, cfg.liveFrameSlots);
+    }
+
     int treatmentStart = cfg.steps;
     int totalSteps = cfg.steps + cfg.extraSteps;
 
     for (int t = 0; t < totalSteps; ++t) {
         double drugConc = 0.0;
-        double inhibitionFactor = 0.0;
         
         if (treatment != "control" && t == treatmentStart) {
             doseTimes.push_back(0);
         }
 
-     
-        if (treatment == "tetra") {
-            drugConc = calculate_total_concentration(cfg.TETRACYCLINEparams, t, treatmentStart);
-            if (drugConc > 1e-9) {
-                const auto& p = cfg.TETRACYCLINEparams;
-                inhibitionFactor = pow(drugConc / p.EC50, p.hillN) / (pow(drugConc / p.EC50, p.hillN) + 1.0);
-                inhibitionFactor = std::min(1.0, inhibitionFactor * p.killScale);
-            }
-        }
-        infection_obj.spread(callose_obj.get_matrix(), cfg.beta, inhibitionFactor, net);
-
-     
         if (treatment == "ctx") {
-            drugConc = calculate_total_concentration(cfg.CTXparams, t, treatmentStart);
-            infection_obj.update(callose_obj.get_matrix(), drugConc, true, cfg.CTXparams);
+            drugConc = calculate_total_concentration(cfg.CTXparams, doseTimes, t, treatmentStart);
+            advance(cfg, net, infection_obj, callose_obj, drugConc, 0.0);
+        } else if (treatment == "tetra") {
+            drugConc = calculate_total_concentration(cfg.TETRACYCLINEparams, doseTimes, t, treatmentStart);
+            advance(cfg, net, infection_obj, callose_obj, 0.0, drugConc);
         } else {
-            
-            infection_obj.update(callose_obj.get_matrix(), (treatment == "tetra" ? drugConc : 0.0), false, cfg.TETRACYCLINEparams);
+            advance(cfg, net, infection_obj, callose_obj, 0.0, 0.0);
         }
-        
-       
-        callose_obj.update(infection_obj.get_matrix(), net);
 
         double meanI = infection_obj.get_mean();
         double meanC = callose_obj.get_mean();
         file << t << "," << meanI << "," << meanC << "," << drugConc << "\n";
 
+        if (live) {
+            live->publish_step(t, meanI, meanC, drugConc);
+            live->publish_frame(t, meanI, meanC, drugConc, infection_obj.get_matrix(), callose_obj.get_matrix());
+        }
+
         if (t % 500 == 0) {
             std::cout << "Step " << t << " | Mean Infection: " << meanI
                  << " | Mean Callose: " << meanC << " | Drug: " << drugConc << "\n";